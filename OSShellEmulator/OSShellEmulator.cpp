@@ -4,6 +4,11 @@
 #include <sstream>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
 
 using namespace std;
 
@@ -18,11 +23,32 @@ struct VFSNode {
     VFSNode(const string& n, bool is_dir = false) : name(n), is_directory(is_dir), permissions("rw-r--r--") {}
 };
 
+//НОВ.СТРУКТ: запрос отмены фонового задания
+//(observed выставляется, только если обход действительно прерван в контрольной точке)
+struct CancelToken {
+    atomic<bool> requested;
+    atomic<bool> observed;
+
+    CancelToken() : requested(false), observed(false) {}
+
+    bool check() {
+        if (requested.load()) {
+            observed = true;
+            return true;
+        }
+        return false;
+    }
+};
+
 //класс для виртуальной файловой системы
 class VirtualFS {
 private:
     VFSNode* root;
-    VFSNode* current_dir;
+    //ИЗМЕНЕНО: atomic - cd меняет только указатель и не требует монопольной блокировки
+    //(узлы никогда не удаляются, поэтому указатель всегда остается валидным)
+    atomic<VFSNode*> current_dir;
+    //НОВОЕ: защита дерева при работе фоновых заданий (чтение - совместно, изменение - монопольно)
+    shared_timed_mutex fs_mutex;
 
 public:
     VirtualFS() {
@@ -52,6 +78,7 @@ public:
 
     //добавление файла
     void addFile(const string& path, const string& content) {
+        unique_lock<shared_timed_mutex> lock(fs_mutex);
         vector<string> parts = splitPath(path);
         VFSNode* node = root;
 
@@ -68,6 +95,7 @@ public:
 
     //добавление директории
     void addDirectory(const string& path) {
+        unique_lock<shared_timed_mutex> lock(fs_mutex);
         vector<string> parts = splitPath(path);
         VFSNode* node = root;
 
@@ -94,10 +122,17 @@ public:
         return parts;
     }
 
+    //НОВ.ФУН: текущая директория (снимок для фонового задания)
+    VFSNode* getCurrentDir() {
+        return current_dir;
+    }
+
     //получение содержимого текущей директории (ОБНОВЛЕНО: с правами доступа)
-    vector<string> listCurrentDir() {
+    //(dir - директория фонового задания; по умолчанию текущая)
+    vector<string> listCurrentDir(VFSNode* dir = nullptr) {
+        shared_lock<shared_timed_mutex> lock(fs_mutex);
         vector<string> result;
-        for (const auto& entry : current_dir->children) {
+        for (const auto& entry : (dir ? dir : current_dir.load())->children) {
             string perms = entry.second->permissions;
             string type = entry.second->is_directory ? "d" : "-";
             result.push_back(type + perms + " " + entry.first +
@@ -108,6 +143,7 @@ public:
 
     //смена директории
     bool changeDir(const string& path) {
+        shared_lock<shared_timed_mutex> lock(fs_mutex);
         if (path == "/") {
             current_dir = root;
             return true;
@@ -128,12 +164,12 @@ public:
                     node = root;
                 }
             }
-            else if (node->children.find(part) == node->children.end() ||
-                !node->children[part]->is_directory) {
-                return false;
-            }
             else {
-                node = node->children[part];
+                auto it = node->children.find(part);
+                if (it == node->children.end() || !it->second->is_directory) {
+                    return false;
+                }
+                node = it->second;
             }
         }
 
@@ -142,20 +178,23 @@ public:
     }
 
     //чтение файла
-    string readFile(const string& path) {
+    string readFile(const string& path, VFSNode* dir = nullptr) {
+        shared_lock<shared_timed_mutex> lock(fs_mutex);
         vector<string> parts = splitPath(path);
-        VFSNode* node = current_dir;
+        VFSNode* node = dir ? dir : current_dir.load();
 
         //обработка абсолютных путей
         if (path[0] == '/') {
             node = root;
         }
 
+        //find вместо operator[]: под shared_lock дерево только читается
         for (size_t i = 0; i < parts.size(); i++) {
-            if (node->children.find(parts[i]) == node->children.end()) {
+            auto it = node->children.find(parts[i]);
+            if (it == node->children.end()) {
                 return "";
             }
-            node = node->children[parts[i]];
+            node = it->second;
         }
 
         return node->is_directory ? "" : node->content;
@@ -168,73 +207,100 @@ public:
 
     //получение текущего пути
     string getCurrentPath() {
+        shared_lock<shared_timed_mutex> lock(fs_mutex);
         //упрощенная реализация
         return current_dir == root ? "/" : "/current";
     }
 
+    //НОВ.ФУН: контрольная точка обхода - кратко отпускает shared_lock,
+    //чтобы touch/chmod не ждали окончания всего обхода; возвращает true при отмене
+    bool checkpoint(shared_lock<shared_timed_mutex>* lock, CancelToken* cancel) {
+        if (lock) {
+            lock->unlock();
+            lock->lock();
+        }
+        return cancel && cancel->check();
+    }
+
     //НОВ.ФУН: вычисление размера файла/директории
-    int calculateSize(VFSNode* node) {
+    //(проверка отмены и отпускание блокировки - на каждом узле обхода; итераторы map
+    //переживают вставку, а узлы не удаляются, поэтому обход можно продолжить после паузы)
+    int calculateSize(VFSNode* node, CancelToken* cancel = nullptr, shared_lock<shared_timed_mutex>* lock = nullptr) {
+        if (checkpoint(lock, cancel)) {
+            return 0;
+        }
         if (!node->is_directory) {
             return node->content.length();
         }
 
         int total_size = 0;
-        for (const auto& child : node->children) {
-            total_size += calculateSize(child.second);
+        for (auto it = node->children.begin(); it != node->children.end(); ++it) {
+            total_size += calculateSize(it->second, cancel, lock);
+            if (cancel && cancel->check()) {
+                break;
+            }
         }
         return total_size;
     }
 
     //НОВ.ФУН: команда du - показ размеров
-    void showDiskUsage(const string& path = "") {
-        VFSNode* target_node = current_dir;
+    void showDiskUsage(const string& path = "", ostream& out = cout, CancelToken* cancel = nullptr, VFSNode* dir = nullptr) {
+        shared_lock<shared_timed_mutex> lock(fs_mutex);
+        VFSNode* target_node = dir ? dir : current_dir.load();
 
         if (!path.empty()) {
             vector<string> parts = splitPath(path);
-            target_node = current_dir;
 
             if (path[0] == '/') {
                 target_node = root;
             }
 
             for (const string& part : parts) {
-                if (target_node->children.find(part) == target_node->children.end()) {
-                    cout << "Ошибка: путь не найден" << endl;
+                auto it = target_node->children.find(part);
+                if (it == target_node->children.end()) {
+                    out << "Ошибка: путь не найден" << endl;
                     return;
                 }
-                target_node = target_node->children[part];
+                target_node = it->second;
             }
         }
 
-        int size = calculateSize(target_node);
+        int size = calculateSize(target_node, cancel, &lock);
+        if (cancel && cancel->check()) {
+            out << "du: прервано" << endl;
+            return;
+        }
         string name = target_node == root ? "/" : target_node->name;
-        cout << size << "\t" << name << (target_node->is_directory ? "/" : "") << endl;
+        out << size << "\t" << name << (target_node->is_directory ? "/" : "") << endl;
     }
 
     //НОВАЯ ФУНКЦИЯ: команда chmod - изменение прав доступа
-    bool changePermissions(const string& path, const string& mode) {
+    bool changePermissions(const string& path, const string& mode, ostream& out = cout, VFSNode* dir = nullptr) {
+        unique_lock<shared_timed_mutex> lock(fs_mutex);
         vector<string> parts = splitPath(path);
-        VFSNode* node = current_dir;
+        VFSNode* node = dir ? dir : current_dir.load();
 
         if (path[0] == '/') {
             node = root;
         }
 
         for (const string& part : parts) {
-            if (node->children.find(part) == node->children.end()) {
+            auto it = node->children.find(part);
+            if (it == node->children.end()) {
                 return false;
             }
-            node = node->children[part];
+            node = it->second;
         }
 
         // Упрощенная реализация - просто сохраняем переданный режим
         node->permissions = mode;
-        cout << "Права доступа изменены: " << path << " -> " << mode << endl;
+        out << "Права доступа изменены: " << path << " -> " << mode << endl;
         return true;
     }
 
     //НОВАЯ ФУНКЦИЯ: команда touch - создание файла
-    bool createFile(const string& path) {
+    bool createFile(const string& path, ostream& out = cout) {
+        unique_lock<shared_timed_mutex> lock(fs_mutex);
         vector<string> parts = splitPath(path);
         VFSNode* node = root;
 
@@ -251,16 +317,29 @@ public:
         if (node->children.find(filename) == node->children.end()) {
             node->children[filename] = new VFSNode(filename, false);
             node->children[filename]->content = ""; // Пустой файл
-            cout << "Создан файл: " << path << endl;
+            out << "Создан файл: " << path << endl;
             return true;
         }
         else {
-            cout << "Файл уже существует: " << path << endl;
+            out << "Файл уже существует: " << path << endl;
             return false;
         }
     }
 };
 
+//НОВ.СТРУКТ: фоновое задание (команда, запущенная с '&')
+struct Job {
+    int id;
+    string command_line;
+    ostringstream output;    //собственный буфер вывода задания
+    atomic<bool> finished;
+    CancelToken cancel;      //отмена для kill
+    VFSNode* cwd;            //директория, из которой запущено задание
+    thread worker;
+
+    Job(int i, const string& cmd, VFSNode* dir) : id(i), command_line(cmd), finished(false), cwd(dir) {}
+};
+
 class Shell {
 private:
     string vfs_name;
@@ -268,9 +347,11 @@ private:
     string vfs_path;    //новый параметр
     string script_path; //новый параметр
     VirtualFS vfs;      //НОВЫЙ ОБЪЕКТ VFS
+    map<int, unique_ptr<Job>> jobs; //НОВОЕ: фоновые задания по номеру
 
     //парсер команд с поддержкой кавычек
-    vector<string> parseCommand(const string& input) {
+    //(last_quoted - был ли последний аргумент в кавычках, нужно для разбора '&')
+    vector<string> parseCommand(const string& input, bool* last_quoted = nullptr) {
         vector<string> args;
         stringstream ss(input);
         string token;
@@ -292,11 +373,13 @@ private:
                 }
                 args.push_back(quoted_token);
                 in_quotes = false;
+                if (last_quoted) *last_quoted = true;
             }
             else {
                 //обычный аргумент
                 if (ss >> token) {
                     args.push_back(token);
+                    if (last_quoted) *last_quoted = false;
                 }
             }
         }
@@ -304,10 +387,10 @@ private:
     }
 
     //НОВ.ФУН: вывод конфигурации
-    void showConfig() {
-        cout << "Конфигурация эмулятора" << endl;
-        cout << "vfs_path: " << (vfs_path.empty() ? "не указан" : vfs_path) << endl;
-        cout << "script_path: " << (script_path.empty() ? "не указан" : script_path) << endl;
+    void showConfig(ostream& out = cout) {
+        out << "Конфигурация эмулятора" << endl;
+        out << "vfs_path: " << (vfs_path.empty() ? "не указан" : vfs_path) << endl;
+        out << "script_path: " << (script_path.empty() ? "не указан" : script_path) << endl;
     }
 
     //НОВ.ФУН: выполнение скрипта
@@ -334,128 +417,15 @@ private:
             //показываем ввод (имитация диалога)
             cout << "VFS> " << line << endl;
 
-            //выполняем команду
+            //выполняем команду (ИЗМЕНЕНО: общий обработчик с REPL, включая '&' и задания)
             auto args = parseCommand(line);
             if (!args.empty()) {
-                string command = args[0];
-
-                if (command == "exit") {
+                if (args[0] == "exit") {
                     cout << "Скрипт прерван командой exit на строке " << line_num << endl;
                     return false;
                 }
-                else if (command == "ls") {
-                    if (!vfs_path.empty()) {
-                        //реальная реализация ls для VFS
-                        auto files = vfs.listCurrentDir();
-                        if (files.empty()) {
-                            cout << "Директория пуста" << endl;
-                        }
-                        else {
-                            cout << "Содержимое директории:" << endl;
-                            for (const auto& file : files) {
-                                cout << "  " << file << endl;
-                            }
-                        }
-                    }
-                    else {
-                        //старая заглушка
-                        cout << "Команда 'ls' (заглушка) с аргументами: ";
-                        for (size_t i = 1; i < args.size(); i++) {
-                            cout << "[" << args[i] << "] ";
-                        }
-                        cout << endl;
-                    }
-                }
-                else if (command == "cd") {
-                    if (!vfs_path.empty() && args.size() > 1) {
-                        if (vfs.changeDir(args[1])) {
-                            cout << "Переход в: " << args[1] << endl;
-                        }
-                        else {
-                            cout << "Ошибка: директория не найдена" << endl;
-                        }
-                    }
-                    else {
-                        //старая заглушка
-                        cout << "Команда 'cd' (заглушка) с аргументами: ";
-                        for (size_t i = 1; i < args.size(); i++) {
-                            cout << "[" << args[i] << "] ";
-                        }
-                        cout << endl;
-                    }
-                }
-                else if (command == "cat") {
-                    if (!vfs_path.empty() && args.size() > 1) {
-                        string content = vfs.readFile(args[1]);
-                        if (!content.empty()) {
-                            cout << content << endl;
-                        }
-                        else {
-                            cout << "Ошибка: файл не найден или недоступен" << endl;
-                        }
-                    }
-                    else {
-                        cout << "Команда 'cat' (заглушка) с аргументами: ";
-                        for (size_t i = 1; i < args.size(); i++) {
-                            cout << "[" << args[i] << "] ";
-                        }
-                        cout << endl;
-                    }
-                }
-                //НОВАЯ КОМАНДА: du
-                else if (command == "du") {
-                    if (!vfs_path.empty()) {
-                        if (args.size() > 1) {
-                            vfs.showDiskUsage(args[1]);
-                        }
-                        else {
-                            vfs.showDiskUsage();
-                        }
-                    }
-                    else {
-                        cout << "Команда 'du' (заглушка) с аргументами: ";
-                        for (size_t i = 1; i < args.size(); i++) {
-                            cout << "[" << args[i] << "] ";
-                        }
-                        cout << endl;
-                    }
-                }
-                //НОВАЯ КОМАНДА: chmod
-                else if (command == "chmod") {
-                    if (!vfs_path.empty() && args.size() > 2) {
-                        if (vfs.changePermissions(args[2], args[1])) {
-                            // Успех
-                        }
-                        else {
-                            cout << "Ошибка: файл не найден" << endl;
-                        }
-                    }
-                    else {
-                        cout << "Команда 'chmod' (заглушка) с аргументами: ";
-                        for (size_t i = 1; i < args.size(); i++) {
-                            cout << "[" << args[i] << "] ";
-                        }
-                        cout << endl;
-                    }
-                }
-                //НОВАЯ КОМАНДА: touch
-                else if (command == "touch") {
-                    if (!vfs_path.empty() && args.size() > 1) {
-                        vfs.createFile(args[1]);
-                    }
-                    else {
-                        cout << "Команда 'touch' (заглушка) с аргументами: ";
-                        for (size_t i = 1; i < args.size(); i++) {
-                            cout << "[" << args[i] << "] ";
-                        }
-                        cout << endl;
-                    }
-                }
-                else if (command == "conf-dump") {
-                    showConfig();
-                }
-                else {
-                    cout << "Ошибка: неизвестная команда '" << command << "' на строке " << line_num << endl;
+                if (!handleInput(args, line)) {
+                    cout << "Ошибка: неизвестная команда '" << args[0] << "' на строке " << line_num << endl;
                     cout << "Скрипт остановлен из-за ошибки" << endl;
                     return false;
                 }
@@ -466,129 +436,308 @@ private:
         return true;
     }
 
-    void executeCommand(const vector<string>& args) {
-        if (args.empty()) return;
+    //ИЗМЕНЕНО: вывод идет в переданный поток (для фоновых заданий - в их буфер),
+    //относительные пути задания разрешаются от cwd; возвращает false для неизвестной команды
+    //(без вывода сообщения об ошибке)
+    bool executeCommand(const vector<string>& args, ostream& out = cout, CancelToken* cancel = nullptr, VFSNode* cwd = nullptr) {
+        if (args.empty()) return true;
 
         string command = args[0];
         if (command == "exit") {
             running = false;
-            cout << "Выход из эмулятора..." << endl;
+            out << "Выход из эмулятора..." << endl;
         }
         else if (command == "ls") {
             if (!vfs_path.empty()) {
                 //реальная реализация ls для VFS
-                auto files = vfs.listCurrentDir();
+                auto files = vfs.listCurrentDir(cwd);
                 if (files.empty()) {
-                    cout << "Директория пуста" << endl;
+                    out << "Директория пуста" << endl;
                 }
                 else {
-                    cout << "Содержимое директории:" << endl;
+                    out << "Содержимое директории:" << endl;
                     for (const auto& file : files) {
-                        cout << "  " << file << endl;
+                        out << "  " << file << endl;
                     }
                 }
             }
             else {
                 //старая заглушка
-                cout << "Команда 'ls' (заглушка) с аргументами: ";
+                out << "Команда 'ls' (заглушка) с аргументами: ";
                 for (size_t i = 1; i < args.size(); i++) {
-                    cout << "[" << args[i] << "] ";
+                    out << "[" << args[i] << "] ";
                 }
-                cout << endl;
+                out << endl;
             }
         }
         else if (command == "cd") {
             if (!vfs_path.empty() && args.size() > 1) {
                 if (vfs.changeDir(args[1])) {
-                    cout << "Переход в: " << args[1] << endl;
+                    out << "Переход в: " << args[1] << endl;
                 }
                 else {
-                    cout << "Ошибка: директория не найдена" << endl;
+                    out << "Ошибка: директория не найдена" << endl;
                 }
             }
             else {
                 //старая заглушка
-                cout << "Команда 'cd' (заглушка) с аргументами: ";
+                out << "Команда 'cd' (заглушка) с аргументами: ";
                 for (size_t i = 1; i < args.size(); i++) {
-                    cout << "[" << args[i] << "] ";
+                    out << "[" << args[i] << "] ";
                 }
-                cout << endl;
+                out << endl;
             }
         }
         else if (command == "cat") {
             if (!vfs_path.empty() && args.size() > 1) {
-                string content = vfs.readFile(args[1]);
+                string content = vfs.readFile(args[1], cwd);
                 if (!content.empty()) {
-                    cout << content << endl;
+                    out << content << endl;
                 }
                 else {
-                    cout << "Ошибка: файл не найден или недоступен" << endl;
+                    out << "Ошибка: файл не найден или недоступен" << endl;
                 }
             }
             else {
-                cout << "Команда 'cat' (заглушка) с аргументами: ";
+                out << "Команда 'cat' (заглушка) с аргументами: ";
                 for (size_t i = 1; i < args.size(); i++) {
-                    cout << "[" << args[i] << "] ";
+                    out << "[" << args[i] << "] ";
                 }
-                cout << endl;
+                out << endl;
             }
         }
         //НОВАЯ КОМАНДА: du
         else if (command == "du") {
             if (!vfs_path.empty()) {
                 if (args.size() > 1) {
-                    vfs.showDiskUsage(args[1]);
+                    vfs.showDiskUsage(args[1], out, cancel, cwd);
                 }
                 else {
-                    vfs.showDiskUsage();
+                    vfs.showDiskUsage("", out, cancel, cwd);
                 }
             }
             else {
-                cout << "Команда 'du' (заглушка) с аргументами: ";
+                out << "Команда 'du' (заглушка) с аргументами: ";
                 for (size_t i = 1; i < args.size(); i++) {
-                    cout << "[" << args[i] << "] ";
+                    out << "[" << args[i] << "] ";
                 }
-                cout << endl;
+                out << endl;
             }
         }
         //НОВАЯ КОМАНДА: chmod
         else if (command == "chmod") {
             if (!vfs_path.empty() && args.size() > 2) {
-                if (vfs.changePermissions(args[2], args[1])) {
+                if (vfs.changePermissions(args[2], args[1], out, cwd)) {
                     // Успех
                 }
                 else {
-                    cout << "Ошибка: файл не найден" << endl;
+                    out << "Ошибка: файл не найден" << endl;
                 }
             }
             else {
-                cout << "Команда 'chmod' (заглушка) с аргументами: ";
+                out << "Команда 'chmod' (заглушка) с аргументами: ";
                 for (size_t i = 1; i < args.size(); i++) {
-                    cout << "[" << args[i] << "] ";
+                    out << "[" << args[i] << "] ";
                 }
-                cout << endl;
+                out << endl;
             }
         }
         //НОВАЯ КОМАНДА: touch
         else if (command == "touch") {
             if (!vfs_path.empty() && args.size() > 1) {
-                vfs.createFile(args[1]);
+                vfs.createFile(args[1], out);
             }
             else {
-                cout << "Команда 'touch' (заглушка) с аргументами: ";
+                out << "Команда 'touch' (заглушка) с аргументами: ";
                 for (size_t i = 1; i < args.size(); i++) {
-                    cout << "[" << args[i] << "] ";
+                    out << "[" << args[i] << "] ";
                 }
-                cout << endl;
+                out << endl;
             }
         }
         //НОВ.КОМ: вывод конфигурации
         else if (command == "conf-dump") {
-            showConfig();
+            showConfig(out);
         }
         else {
-            cout << "Ошибка: неизвестная команда '" << command << "'" << endl;
+            //сообщение выводит вызывающий код (в скрипте - с номером строки)
+            return false;
+        }
+        return true;
+    }
+
+    //НОВ.ФУН: запуск команды фоновым заданием в отдельном потоке
+    void startJob(const vector<string>& args, const string& command_line) {
+        int id = jobs.empty() ? 1 : jobs.rbegin()->first + 1;
+        //директория фиксируется в момент ввода '&', а не при старте потока
+        Job* job = new Job(id, command_line, vfs.getCurrentDir());
+        jobs[id] = unique_ptr<Job>(job);
+
+        job->worker = thread([this, job, args]() {
+            if (!executeCommand(args, job->output, &job->cancel, job->cwd)) {
+                job->output << "Ошибка: неизвестная команда '" << args[0] << "'" << endl;
+            }
+            job->finished = true;
+        });
+        cout << "[" << id << "] " << command_line << endl;
+    }
+
+    //НОВ.ФУН: ожидание задания, вывод его буфера и удаление из списка
+    void finishJob(int id) {
+        Job* job = jobs[id].get();
+        if (job->worker.joinable()) {
+            job->worker.join();
         }
+        //статус определяется только после join - до этого отмена могла еще не сработать
+        cout << "[" << id << "] " << jobStatus(id) << "\t" << job->command_line << endl;
+        cout << job->output.str();
+        jobs.erase(id);
+    }
+
+    //НОВ.ФУН: вывод завершившихся заданий (вызывается перед приглашением)
+    void reapJobs() {
+        vector<int> done;
+        for (const auto& entry : jobs) {
+            if (entry.second->finished) {
+                done.push_back(entry.first);
+            }
+        }
+        for (int id : done) {
+            finishJob(id);
+        }
+    }
+
+    //НОВ.ФУН: статус задания для вывода
+    string jobStatus(int id) {
+        return jobs[id]->cancel.observed ? "Прервано" : "Завершено";
+    }
+
+    //НОВ.ФУН: разбор номера задания вида %N или N (-1 если задания нет)
+    int findJob(const string& spec) {
+        string number = (!spec.empty() && spec[0] == '%') ? spec.substr(1) : spec;
+        //не более 9 цифр, чтобы stoi не вышел за пределы int
+        if (number.empty() || number.size() > 9 || number.find_first_not_of("0123456789") != string::npos) {
+            return -1;
+        }
+        int id = stoi(number);
+        return jobs.count(id) ? id : -1;
+    }
+
+    //НОВ.ФУН: отмена и ожидание всех заданий (при выходе из эмулятора)
+    void stopJobs() {
+        for (const auto& entry : jobs) {
+            entry.second->cancel.requested = true;
+        }
+        for (const auto& entry : jobs) {
+            if (entry.second->worker.joinable()) {
+                entry.second->worker.join();
+            }
+        }
+        jobs.clear();
+    }
+
+    //НОВ.ФУН: команды управления заданиями: jobs, fg, wait, kill
+    bool executeJobCommand(const vector<string>& args) {
+        string command = args[0];
+        if (command == "jobs") {
+            if (jobs.empty()) {
+                cout << "Нет фоновых заданий" << endl;
+            }
+            for (const auto& entry : jobs) {
+                cout << "[" << entry.first << "] "
+                    << (entry.second->finished ? "Завершено" : "Выполняется")
+                    << "\t" << entry.second->command_line << endl;
+            }
+        }
+        else if (command == "fg") {
+            int id = args.size() > 1 ? findJob(args[1]) : (jobs.empty() ? -1 : jobs.rbegin()->first);
+            if (id == -1) {
+                cout << "Ошибка: нет такого задания" << endl;
+            }
+            else {
+                finishJob(id);
+            }
+        }
+        else if (command == "wait") {
+            if (args.size() > 1) {
+                int id = findJob(args[1]);
+                if (id == -1) {
+                    cout << "Ошибка: нет такого задания" << endl;
+                }
+                else {
+                    finishJob(id);
+                }
+            }
+            else {
+                while (!jobs.empty()) {
+                    int id = jobs.begin()->first;
+                    finishJob(id);
+                }
+            }
+        }
+        else if (command == "kill") {
+            if (args.size() < 2 || args[1].empty() || args[1][0] != '%') {
+                cout << "Использование: kill %N" << endl;
+            }
+            else {
+                int id = findJob(args[1]);
+                if (id == -1) {
+                    cout << "Ошибка: нет такого задания" << endl;
+                }
+                else {
+                    //статус берется после ожидания: "Прервано" только если задание
+                    //действительно остановилось в контрольной точке, а не успело завершиться
+                    jobs[id]->cancel.requested = true;
+                    finishJob(id);
+                }
+            }
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+
+    //НОВ.ФУН: обработка строки ввода с учетом '&' в конце
+    //(возвращает false для неизвестной команды - используется скриптом для остановки)
+    bool handleInput(vector<string> args, const string& input) {
+        //'&' в кавычках ("file&") - обычный аргумент, а не фоновый запуск
+        bool last_quoted = false;
+        parseCommand(input, &last_quoted);
+
+        bool background = false;
+        string& last = args.back();
+        if (!last_quoted && last == "&") {
+            background = true;
+            args.pop_back();
+        }
+        else if (!last_quoted && last.size() > 1 && last.back() == '&') {
+            background = true;
+            last.pop_back();
+        }
+        if (args.empty()) {
+            cout << "Ошибка: пустая команда перед '&'" << endl;
+            return true;
+        }
+
+        string command = args[0];
+        bool job_command = command == "jobs" || command == "fg" || command == "wait" || command == "kill";
+        //cd в фоне сменил бы текущую директорию сессии в непредсказуемый момент
+        if (background && (job_command || command == "exit" || command == "cd")) {
+            cout << "Ошибка: команду '" << command << "' нельзя запустить в фоне" << endl;
+        }
+        else if (job_command) {
+            executeJobCommand(args);
+        }
+        else if (background) {
+            string command_line = input.substr(0, input.find_last_of('&'));
+            command_line.erase(command_line.find_last_not_of(" \t") + 1);
+            startJob(args, command_line);
+        }
+        else {
+            return executeCommand(args);
+        }
+        return true;
     }
 
 public:
@@ -621,6 +770,7 @@ public:
         //НОВ.КОД: выполнение стартового скрипта если указан
         if (!script_path.empty()) {
             if (!executeScript(script_path)) {
+                stopJobs(); //фоновые задания скрипта не должны пережить эмулятор
                 return; //завершаем если скрипт завершился с ошибкой
             }
             cout << endl;
@@ -628,9 +778,12 @@ public:
         cout << "Эмулятор командной оболочки ОС" << endl;
         cout << "VFS: " << vfs_name << endl;
         cout << "Введите 'exit' для выхода, 'conf-dump' для просмотра конфигурации" << endl << endl;
-        cout << "Доступные команды: ls, cd, cat, du, chmod, touch, conf-dump, exit" << endl << endl;
+        cout << "Доступные команды: ls, cd, cat, du, chmod, touch, conf-dump, exit" << endl;
+        cout << "Фоновые задания: <команда> &, jobs, fg [%N], wait [%N], kill %N" << endl << endl;
 
         while (running) {
+            //вывод завершившихся фоновых заданий
+            reapJobs();
             //приглашение к вводу
             cout << vfs_name << "> ";
             //чтение ввода
@@ -639,9 +792,14 @@ public:
             //парсинг и выполнение команды
             auto args = parseCommand(input);
             if (!args.empty()) {
-                executeCommand(args);
+                if (!handleInput(args, input)) {
+                    cout << "Ошибка: неизвестная команда '" << args[0] << "'" << endl;
+                }
             }
         }
+
+        //отмена незавершенных фоновых заданий при выходе
+        stopJobs();
     }
 };
 